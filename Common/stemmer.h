@@ -0,0 +1,609 @@
+#pragma once
+
+#include <array>
+#include <cctype>
+#include <cstddef>
+#include <string>
+#include <string_view>
+#include <vector>
+
+// Стеммер для русского и английского языков по мотивам алгоритмов Snowball.
+// Словоформы одного слова («поиск», «поиска», «поиском») сводятся к общей основе,
+// поэтому в таблицу words попадает одна строка вместо нескольких.
+// Таблицы суффиксов сортируются по убыванию длины на этапе компиляции,
+// а сам стемминг выполняется на месте, без выделения памяти.
+namespace stemmer {
+
+namespace detail {
+
+// Максимальная длина слова в байтах, которое имеет смысл обрабатывать
+constexpr std::size_t max_word_length = 64;
+
+// Дополнительное условие, при котором правило применяется
+enum Condition : int {
+    always = 0,
+    after_a_ya,      // перед суффиксом стоит «а» или «я» (группа 1 в Snowball)
+    after_l,         // перед суффиксом стоит «l»
+    after_li_ending, // перед суффиксом стоит одна из букв c d e g h k m n r t
+    after_s_or_t,    // перед суффиксом стоит «s» или «t»
+    in_r2            // суффикс целиком лежит в области R2
+};
+
+// Правило таблицы суффиксов: суффикс, его замена и условие применения
+struct Rule {
+    std::string_view suffix;
+    std::string_view replacement;
+    Condition condition;
+};
+
+// Сортировка правил по убыванию длины суффикса (вставками, чтобы работала в constexpr).
+// Первое совпавшее при проходе по таблице правило — самое длинное, как в among из Snowball
+template <std::size_t N>
+constexpr std::array<Rule, N> make_table(const Rule (&rules)[N]) {
+    std::array<Rule, N> table{};
+    for (std::size_t i = 0; i < N; ++i) {
+        std::size_t j = i;
+        while (j > 0 && table[j - 1].suffix.size() < rules[i].suffix.size()) {
+            table[j] = table[j - 1];
+            --j;
+        }
+        table[j] = rules[i];
+    }
+    return table;
+}
+
+// Проверки таблиц на этапе компиляции
+template <std::size_t N>
+constexpr bool is_valid_table(const std::array<Rule, N>& table) {
+    for (std::size_t i = 0; i < N; ++i) {
+        if (table[i].suffix.empty() || table[i].replacement.size() > table[i].suffix.size()) return false;
+        if (i > 0 && table[i - 1].suffix.size() < table[i].suffix.size()) return false;
+    }
+    return true;
+}
+
+template <std::size_t N>
+constexpr bool is_cyrillic_table(const std::array<Rule, N>& table) {
+    for (const Rule& rule : table) {
+        if (rule.suffix.size() % 2 != 0) return false;
+        for (std::size_t i = 0; i < rule.suffix.size(); i += 2) {
+            const unsigned char lead = static_cast<unsigned char>(rule.suffix[i]);
+            if (lead != 0xD0 && lead != 0xD1) return false;
+        }
+    }
+    return true;
+}
+
+constexpr bool ends_with(std::string_view word, std::string_view suffix) {
+    return word.size() >= suffix.size() && word.substr(word.size() - suffix.size()) == suffix;
+}
+
+// Поиск самого длинного суффикса из таблицы, которым оканчивается слово
+template <std::size_t N>
+constexpr const Rule* find_suffix(const std::array<Rule, N>& table, std::string_view word) {
+    for (const Rule& rule : table) {
+        if (ends_with(word, rule.suffix)) return &rule;
+    }
+    return nullptr;
+}
+
+// Поиск слова целиком в таблице исключений
+template <std::size_t N>
+constexpr const Rule* find_word(const std::array<Rule, N>& table, std::string_view word) {
+    for (const Rule& rule : table) {
+        if (rule.suffix == word) return &rule;
+    }
+    return nullptr;
+}
+
+// ---------------------------------------------------------------------------
+// Русский язык. Все буквы кириллицы в UTF-8 занимают два байта,
+// поэтому позиции в слове всегда чётные.
+// ---------------------------------------------------------------------------
+
+constexpr Rule ru_perfective_gerund_rules[] = {
+    {"в", "", after_a_ya}, {"вши", "", after_a_ya}, {"вшись", "", after_a_ya},
+    {"ив", "", always}, {"ивши", "", always}, {"ившись", "", always},
+    {"ыв", "", always}, {"ывши", "", always}, {"ывшись", "", always},
+};
+
+constexpr Rule ru_reflexive_rules[] = {
+    {"ся", "", always}, {"сь", "", always},
+};
+
+constexpr Rule ru_adjective_rules[] = {
+    {"ее", "", always}, {"ие", "", always}, {"ые", "", always}, {"ое", "", always},
+    {"ими", "", always}, {"ыми", "", always}, {"ей", "", always}, {"ий", "", always},
+    {"ый", "", always}, {"ой", "", always}, {"ем", "", always}, {"им", "", always},
+    {"ым", "", always}, {"ом", "", always}, {"его", "", always}, {"ого", "", always},
+    {"ему", "", always}, {"ому", "", always}, {"их", "", always}, {"ых", "", always},
+    {"ую", "", always}, {"юю", "", always}, {"ая", "", always}, {"яя", "", always},
+    {"ою", "", always}, {"ею", "", always},
+};
+
+constexpr Rule ru_participle_rules[] = {
+    {"ем", "", after_a_ya}, {"нн", "", after_a_ya}, {"вш", "", after_a_ya},
+    {"ющ", "", after_a_ya}, {"щ", "", after_a_ya},
+    {"ивш", "", always}, {"ывш", "", always}, {"ующ", "", always},
+};
+
+constexpr Rule ru_verb_rules[] = {
+    {"ла", "", after_a_ya}, {"на", "", after_a_ya}, {"ете", "", after_a_ya},
+    {"йте", "", after_a_ya}, {"ли", "", after_a_ya}, {"й", "", after_a_ya},
+    {"л", "", after_a_ya}, {"ем", "", after_a_ya}, {"н", "", after_a_ya},
+    {"ло", "", after_a_ya}, {"но", "", after_a_ya}, {"ет", "", after_a_ya},
+    {"ют", "", after_a_ya}, {"ны", "", after_a_ya}, {"ть", "", after_a_ya},
+    {"ешь", "", after_a_ya}, {"нно", "", after_a_ya},
+    {"ила", "", always}, {"ыла", "", always}, {"ена", "", always}, {"ейте", "", always},
+    {"уйте", "", always}, {"ите", "", always}, {"или", "", always}, {"ыли", "", always},
+    {"ей", "", always}, {"уй", "", always}, {"ил", "", always}, {"ыл", "", always},
+    {"им", "", always}, {"ым", "", always}, {"ен", "", always}, {"ило", "", always},
+    {"ыло", "", always}, {"ено", "", always}, {"ят", "", always}, {"ует", "", always},
+    {"уют", "", always}, {"ит", "", always}, {"ыт", "", always}, {"ены", "", always},
+    {"ить", "", always}, {"ыть", "", always}, {"ишь", "", always}, {"ую", "", always},
+    {"ю", "", always},
+};
+
+constexpr Rule ru_noun_rules[] = {
+    {"а", "", always}, {"ев", "", always}, {"ов", "", always}, {"ие", "", always},
+    {"ье", "", always}, {"е", "", always}, {"иями", "", always}, {"ями", "", always},
+    {"ами", "", always}, {"еи", "", always}, {"ии", "", always}, {"и", "", always},
+    {"ией", "", always}, {"ей", "", always}, {"ой", "", always}, {"ий", "", always},
+    {"й", "", always}, {"иям", "", always}, {"ям", "", always}, {"ием", "", always},
+    {"ем", "", always}, {"ам", "", always}, {"ом", "", always}, {"о", "", always},
+    {"у", "", always}, {"ах", "", always}, {"иях", "", always}, {"ях", "", always},
+    {"ы", "", always}, {"ь", "", always}, {"ию", "", always}, {"ью", "", always},
+    {"ю", "", always}, {"ия", "", always}, {"ья", "", always}, {"я", "", always},
+};
+
+constexpr Rule ru_derivational_rules[] = {
+    {"ост", "", always}, {"ость", "", always},
+};
+
+constexpr Rule ru_superlative_rules[] = {
+    {"ейш", "", always}, {"ейше", "", always},
+};
+
+constexpr auto ru_perfective_gerund = make_table(ru_perfective_gerund_rules);
+constexpr auto ru_reflexive = make_table(ru_reflexive_rules);
+constexpr auto ru_adjective = make_table(ru_adjective_rules);
+constexpr auto ru_participle = make_table(ru_participle_rules);
+constexpr auto ru_verb = make_table(ru_verb_rules);
+constexpr auto ru_noun = make_table(ru_noun_rules);
+constexpr auto ru_derivational = make_table(ru_derivational_rules);
+constexpr auto ru_superlative = make_table(ru_superlative_rules);
+
+static_assert(is_valid_table(ru_perfective_gerund) && is_cyrillic_table(ru_perfective_gerund), "ru_perfective_gerund");
+static_assert(is_valid_table(ru_reflexive) && is_cyrillic_table(ru_reflexive), "ru_reflexive");
+static_assert(is_valid_table(ru_adjective) && is_cyrillic_table(ru_adjective), "ru_adjective");
+static_assert(is_valid_table(ru_participle) && is_cyrillic_table(ru_participle), "ru_participle");
+static_assert(is_valid_table(ru_verb) && is_cyrillic_table(ru_verb), "ru_verb");
+static_assert(is_valid_table(ru_noun) && is_cyrillic_table(ru_noun), "ru_noun");
+static_assert(is_valid_table(ru_derivational) && is_cyrillic_table(ru_derivational), "ru_derivational");
+static_assert(is_valid_table(ru_superlative) && is_cyrillic_table(ru_superlative), "ru_superlative");
+
+// Является ли слово строчной кириллицей в UTF-8 (а–я, ё)
+inline bool is_russian(std::string_view word) {
+    if (word.empty() || word.size() % 2 != 0) return false;
+    for (std::size_t i = 0; i < word.size(); i += 2) {
+        const unsigned char lead = static_cast<unsigned char>(word[i]);
+        const unsigned char tail = static_cast<unsigned char>(word[i + 1]);
+        const bool lower_a_p = lead == 0xD0 && tail >= 0xB0 && tail <= 0xBF;
+        const bool lower_r_ya = lead == 0xD1 && ((tail >= 0x80 && tail <= 0x8F) || tail == 0x91);
+        if (!lower_a_p && !lower_r_ya) return false;
+    }
+    return true;
+}
+
+inline bool ru_is_vowel(std::string_view word, std::size_t pos) {
+    const std::string_view letter = word.substr(pos, 2);
+    return letter == "а" || letter == "е" || letter == "и" || letter == "о" || letter == "у" ||
+           letter == "ы" || letter == "э" || letter == "ю" || letter == "я";
+}
+
+// Начало области после первой согласной, следующей за гласной (R1/R2 в терминах Snowball)
+inline std::size_t ru_region_after(std::string_view word, std::size_t from) {
+    for (std::size_t i = from; i + 4 <= word.size(); i += 2) {
+        if (ru_is_vowel(word, i) && !ru_is_vowel(word, i + 2)) return i + 4;
+    }
+    return word.size();
+}
+
+// Возвращает длину удаляемого суффикса из таблицы или 0, если правило не подошло.
+// Поиск идёт только внутри области, начинающейся с позиции region
+template <std::size_t N>
+std::size_t ru_suffix(const std::array<Rule, N>& table, std::string_view word, std::size_t region) {
+    const std::string_view tail = word.substr(region);
+    const Rule* rule = find_suffix(table, tail);
+    if (!rule) return 0;
+    if (rule->condition == after_a_ya) {
+        const std::size_t before = tail.size() - rule->suffix.size();
+        if (before < 2) return 0;
+        const std::string_view prev = tail.substr(before - 2, 2);
+        if (prev != "а" && prev != "я") return 0;
+    }
+    return rule->suffix.size();
+}
+
+// Стемминг русского слова на месте. Возвращает новую длину слова в байтах
+inline std::size_t stem_russian(char* data, std::size_t size) {
+    // «ё» приравниваем к «е»
+    for (std::size_t i = 0; i < size; i += 2) {
+        if (static_cast<unsigned char>(data[i]) == 0xD1 && static_cast<unsigned char>(data[i + 1]) == 0x91) {
+            data[i] = static_cast<char>(0xD0);
+            data[i + 1] = static_cast<char>(0xB5);
+        }
+    }
+
+    const std::string_view original(data, size);
+    std::size_t rv = size;
+    for (std::size_t i = 0; i < size; i += 2) {
+        if (ru_is_vowel(original, i)) {
+            rv = i + 2;
+            break;
+        }
+    }
+    const std::size_t r1 = ru_region_after(original, 0);
+    const std::size_t r2 = ru_region_after(original, r1);
+
+    auto word = [&] { return std::string_view(data, size); };
+
+    // Шаг 1: деепричастие, либо возвратность и затем прилагательное/причастие, глагол или существительное
+    if (std::size_t cut = ru_suffix(ru_perfective_gerund, word(), rv)) {
+        size -= cut;
+    } else {
+        size -= ru_suffix(ru_reflexive, word(), rv);
+        if ((cut = ru_suffix(ru_adjective, word(), rv))) {
+            size -= cut;
+            size -= ru_suffix(ru_participle, word(), rv);
+        } else if ((cut = ru_suffix(ru_verb, word(), rv))) {
+            size -= cut;
+        } else {
+            size -= ru_suffix(ru_noun, word(), rv);
+        }
+    }
+
+    // Шаг 2: окончание «и»
+    if (size >= rv + 2 && ends_with(word(), "и")) size -= 2;
+
+    // Шаг 3: словообразовательный суффикс в R2
+    if (r2 <= size) size -= ru_suffix(ru_derivational, word(), r2 > rv ? r2 : rv);
+
+    // Шаг 4: превосходная степень, двойное «н» и мягкий знак
+    const std::size_t superlative = ru_suffix(ru_superlative, word(), rv);
+    size -= superlative;
+    if (size >= rv + 4 && ends_with(word(), "нн")) {
+        size -= 2;
+    } else if (!superlative && size >= rv + 2 && ends_with(word(), "ь")) {
+        size -= 2;
+    }
+
+    return size;
+}
+
+// ---------------------------------------------------------------------------
+// Английский язык (Porter2). Буква «y», играющая роль согласной,
+// на время работы помечается как «Y».
+// ---------------------------------------------------------------------------
+
+constexpr Rule en_step2_rules[] = {
+    {"tional", "tion", always}, {"enci", "ence", always}, {"anci", "ance", always},
+    {"abli", "able", always}, {"entli", "ent", always}, {"izer", "ize", always},
+    {"ization", "ize", always}, {"ational", "ate", always}, {"ation", "ate", always},
+    {"ator", "ate", always}, {"alism", "al", always}, {"aliti", "al", always},
+    {"alli", "al", always}, {"fulness", "ful", always}, {"ousli", "ous", always},
+    {"ousness", "ous", always}, {"iveness", "ive", always}, {"iviti", "ive", always},
+    {"biliti", "ble", always}, {"bli", "ble", always}, {"ogi", "og", after_l},
+    {"fulli", "ful", always}, {"lessli", "less", always}, {"li", "", after_li_ending},
+};
+
+constexpr Rule en_step3_rules[] = {
+    {"tional", "tion", always}, {"ational", "ate", always}, {"alize", "al", always},
+    {"icate", "ic", always}, {"iciti", "ic", always}, {"ical", "ic", always},
+    {"ful", "", always}, {"ness", "", always}, {"ative", "", in_r2},
+};
+
+constexpr Rule en_step4_rules[] = {
+    {"al", "", always}, {"ance", "", always}, {"ence", "", always}, {"er", "", always},
+    {"ic", "", always}, {"able", "", always}, {"ible", "", always}, {"ant", "", always},
+    {"ement", "", always}, {"ment", "", always}, {"ent", "", always}, {"ism", "", always},
+    {"ate", "", always}, {"iti", "", always}, {"ous", "", always}, {"ive", "", always},
+    {"ize", "", always}, {"ion", "", after_s_or_t},
+};
+
+// Исключения Porter2: слова, основа которых задана явно (без изменений, если замена совпадает со словом)
+constexpr Rule en_exception_rules[] = {
+    {"skis", "ski", always}, {"skies", "sky", always}, {"dying", "die", always},
+    {"lying", "lie", always}, {"tying", "tie", always}, {"idly", "idl", always},
+    {"gently", "gentl", always}, {"ugly", "ugli", always}, {"early", "earli", always},
+    {"only", "onli", always}, {"singly", "singl", always}, {"sky", "sky", always},
+    {"news", "news", always}, {"howe", "howe", always}, {"atlas", "atlas", always},
+    {"cosmos", "cosmos", always}, {"bias", "bias", always}, {"andes", "andes", always},
+};
+
+// Слова, на которых стемминг останавливается после шага 1a
+constexpr Rule en_step1a_invariant_rules[] = {
+    {"inning", "inning", always}, {"outing", "outing", always}, {"canning", "canning", always},
+    {"herring", "herring", always}, {"earring", "earring", always}, {"proceed", "proceed", always},
+    {"exceed", "exceed", always}, {"succeed", "succeed", always},
+};
+
+constexpr auto en_exceptions = make_table(en_exception_rules);
+constexpr auto en_step1a_invariants = make_table(en_step1a_invariant_rules);
+constexpr auto en_step2 = make_table(en_step2_rules);
+constexpr auto en_step3 = make_table(en_step3_rules);
+constexpr auto en_step4 = make_table(en_step4_rules);
+
+static_assert(is_valid_table(en_exceptions), "en_exceptions");
+static_assert(is_valid_table(en_step1a_invariants), "en_step1a_invariants");
+static_assert(is_valid_table(en_step2), "en_step2");
+static_assert(is_valid_table(en_step3), "en_step3");
+static_assert(is_valid_table(en_step4), "en_step4");
+
+// Является ли слово строчным ASCII-словом
+inline bool is_english(std::string_view word) {
+    if (word.empty()) return false;
+    for (char c : word) {
+        if (c < 'a' || c > 'z') return false;
+    }
+    return true;
+}
+
+constexpr bool en_is_vowel(char c) {
+    return c == 'a' || c == 'e' || c == 'i' || c == 'o' || c == 'u' || c == 'y';
+}
+
+inline std::size_t en_region_after(std::string_view word, std::size_t from) {
+    for (std::size_t i = from; i + 1 < word.size(); ++i) {
+        if (en_is_vowel(word[i]) && !en_is_vowel(word[i + 1])) return i + 2;
+    }
+    return word.size();
+}
+
+// Оканчивается ли слово коротким слогом: согласная-гласная-согласная (кроме w, x, Y)
+// или гласная-согласная в начале слова
+inline bool en_ends_with_short_syllable(std::string_view word) {
+    const std::size_t n = word.size();
+    if (n == 2) return en_is_vowel(word[0]) && !en_is_vowel(word[1]);
+    if (n < 3) return false;
+    const char last = word[n - 1];
+    return !en_is_vowel(word[n - 3]) && en_is_vowel(word[n - 2]) && !en_is_vowel(last) &&
+           last != 'w' && last != 'x' && last != 'Y';
+}
+
+inline bool en_has_vowel(std::string_view word) {
+    for (char c : word) {
+        if (en_is_vowel(c)) return true;
+    }
+    return false;
+}
+
+// Применяет правило из таблицы шагов 2–4, если суффикс лежит в области region
+template <std::size_t N>
+std::size_t en_apply(const std::array<Rule, N>& table, char* data, std::size_t size,
+                     std::size_t region, std::size_t r2) {
+    const std::string_view word(data, size);
+    const Rule* rule = find_suffix(table, word);
+    if (!rule) return size;
+    const std::size_t stem = size - rule->suffix.size();
+    if (stem < region) return size;
+    switch (rule->condition) {
+        case after_l:
+            if (stem == 0 || data[stem - 1] != 'l') return size;
+            break;
+        case after_li_ending:
+            if (stem == 0 || std::string_view("cdeghkmnrt").find(data[stem - 1]) == std::string_view::npos) return size;
+            break;
+        case after_s_or_t:
+            if (stem == 0 || (data[stem - 1] != 's' && data[stem - 1] != 't')) return size;
+            break;
+        case in_r2:
+            if (stem < r2) return size;
+            break;
+        default:
+            break;
+    }
+    for (std::size_t i = 0; i < rule->replacement.size(); ++i) data[stem + i] = rule->replacement[i];
+    return stem + rule->replacement.size();
+}
+
+// Стемминг английского слова на месте. Возвращает новую длину слова в байтах.
+// Слово никогда не становится длиннее исходного, поэтому запись в буфер безопасна
+inline std::size_t stem_english(char* data, std::size_t size) {
+    if (size <= 2) return size;
+
+    if (const Rule* exception = find_word(en_exceptions, std::string_view(data, size))) {
+        for (std::size_t i = 0; i < exception->replacement.size(); ++i) data[i] = exception->replacement[i];
+        return exception->replacement.size();
+    }
+
+    // Помечаем «y» в начале слова и после гласной как согласную
+    if (data[0] == 'y') data[0] = 'Y';
+    for (std::size_t i = 1; i < size; ++i) {
+        if (data[i] == 'y' && en_is_vowel(data[i - 1])) data[i] = 'Y';
+    }
+
+    const std::string_view original(data, size);
+    std::size_t r1;
+    if (original.substr(0, 5) == "gener" || original.substr(0, 5) == "arsen") {
+        r1 = 5;
+    } else if (original.substr(0, 6) == "commun") {
+        r1 = 6;
+    } else {
+        r1 = en_region_after(original, 0);
+    }
+    const std::size_t r2 = en_region_after(original, r1);
+
+    auto word = [&] { return std::string_view(data, size); };
+
+    // Шаг 1a: множественное число
+    if (ends_with(word(), "sses")) {
+        size -= 2;
+    } else if (ends_with(word(), "ied") || ends_with(word(), "ies")) {
+        // «cries» → «cri», но «ties» → «tie»
+        if (size > 4) {
+            size -= 2;
+            data[size - 1] = 'i';
+        } else {
+            size -= 1;
+        }
+    } else if (ends_with(word(), "us") || ends_with(word(), "ss")) {
+        // Оставляем без изменений
+    } else if (ends_with(word(), "s") && size >= 3 && en_has_vowel(word().substr(0, size - 2))) {
+        size -= 1;
+    }
+
+    if (find_word(en_step1a_invariants, word())) {
+        for (std::size_t i = 0; i < size; ++i) {
+            if (data[i] == 'Y') data[i] = 'y';
+        }
+        return size;
+    }
+
+    // Шаг 1b: окончания -eed, -ed, -ing и их наречные формы
+    if (ends_with(word(), "eedly") || ends_with(word(), "eed")) {
+        const std::size_t suffix = ends_with(word(), "eedly") ? 5 : 3;
+        if (size - suffix >= r1) size = size - suffix + 2;
+    } else {
+        std::size_t suffix = 0;
+        if (ends_with(word(), "ingly")) suffix = 5;
+        else if (ends_with(word(), "edly")) suffix = 4;
+        else if (ends_with(word(), "ing")) suffix = 3;
+        else if (ends_with(word(), "ed")) suffix = 2;
+
+        if (suffix && en_has_vowel(word().substr(0, size - suffix))) {
+            size -= suffix;
+            const std::string_view stem = word();
+            if (ends_with(stem, "at") || ends_with(stem, "bl") || ends_with(stem, "iz")) {
+                data[size++] = 'e';
+            } else if (size >= 2 && data[size - 1] == data[size - 2] &&
+                       std::string_view("bdfgmnprt").find(data[size - 1]) != std::string_view::npos) {
+                size -= 1;
+            } else if (r1 >= size && en_ends_with_short_syllable(stem)) {
+                data[size++] = 'e';
+            }
+        }
+    }
+
+    // Шаг 1c: конечная «y» после согласной заменяется на «i»
+    if (size > 2 && (data[size - 1] == 'y' || data[size - 1] == 'Y') && !en_is_vowel(data[size - 2])) {
+        data[size - 1] = 'i';
+    }
+
+    // Шаги 2–4: словообразовательные суффиксы
+    size = en_apply(en_step2, data, size, r1, r2);
+    size = en_apply(en_step3, data, size, r1, r2);
+    size = en_apply(en_step4, data, size, r2, r2);
+
+    // Шаг 5: конечные «e» и «l»
+    if (ends_with(word(), "e")) {
+        const std::size_t stem = size - 1;
+        if (stem >= r2 || (stem >= r1 && !en_ends_with_short_syllable(std::string_view(data, stem)))) {
+            size = stem;
+        }
+    } else if (ends_with(word(), "ll") && size - 1 >= r2) {
+        size -= 1;
+    }
+
+    for (std::size_t i = 0; i < size; ++i) {
+        if (data[i] == 'Y') data[i] = 'y';
+    }
+    return size;
+}
+
+// Длина разделителя слов в байтах, начинающегося с позиции pos, или 0, если там часть слова.
+// Разделителями считаются пробелы и знаки препинания ASCII, а также типичные для русских
+// текстов символы Юникода: неразрывный пробел, кавычки «» и „“, тире, многоточие,
+// невидимые метки направления письма (всё из блоков U+00A0–U+00BF и U+2000–U+206F)
+inline std::size_t separator_length(std::string_view text, std::size_t pos) {
+    const unsigned char c = static_cast<unsigned char>(text[pos]);
+    if (c < 0x80) return std::isalnum(c) ? 0 : 1;
+
+    const auto byte = [&](std::size_t offset) {
+        return pos + offset < text.size() ? static_cast<unsigned char>(text[pos + offset]) : 0;
+    };
+    // U+00A0–U+00BF: C2 A0 … C2 BF
+    if (c == 0xC2 && byte(1) >= 0xA0 && byte(1) <= 0xBF) return 2;
+    // U+2000–U+206F: E2 80 80 … E2 81 AF
+    if (c == 0xE2 && (byte(1) == 0x80 || (byte(1) == 0x81 && byte(2) <= 0xAF)) && byte(2) >= 0x80) return 3;
+    // U+FEFF (BOM)
+    if (c == 0xEF && byte(1) == 0xBB && byte(2) == 0xBF) return 3;
+    return 0;
+}
+
+} // namespace detail
+
+// Приведение к нижнему регистру латиницы и кириллицы в UTF-8 на месте.
+// Длина строки при этом не меняется
+inline void to_lower_utf8(std::string& text) {
+    for (std::size_t i = 0; i < text.size(); ++i) {
+        const unsigned char c = static_cast<unsigned char>(text[i]);
+        if (c >= 'A' && c <= 'Z') {
+            text[i] = static_cast<char>(c + ('a' - 'A'));
+        } else if (c == 0xD0 && i + 1 < text.size()) {
+            const unsigned char next = static_cast<unsigned char>(text[i + 1]);
+            if (next >= 0x90 && next <= 0x9F) {        // А–П
+                text[i + 1] = static_cast<char>(next + 0x20);
+            } else if (next >= 0xA0 && next <= 0xAF) { // Р–Я
+                text[i] = static_cast<char>(0xD1);
+                text[i + 1] = static_cast<char>(next - 0x20);
+            } else if (next == 0x81) {                 // Ё
+                text[i] = static_cast<char>(0xD1);
+                text[i + 1] = static_cast<char>(0x91);
+            }
+            ++i;
+        }
+    }
+}
+
+// Количество букв (кодовых точек) в строке UTF-8: байты продолжения 10xxxxxx не считаются
+inline std::size_t letter_count(std::string_view word) {
+    std::size_t count = 0;
+    for (char c : word) {
+        if ((static_cast<unsigned char>(c) & 0xC0) != 0x80) ++count;
+    }
+    return count;
+}
+
+// Сводит слово в нижнем регистре к его основе. Слова, не являющиеся
+// полностью русскими или английскими (числа, смешанный алфавит), не меняются
+inline void stem(std::string& word) {
+    if (word.size() > detail::max_word_length) return;
+    if (detail::is_russian(word)) {
+        word.resize(detail::stem_russian(word.data(), word.size()));
+    } else if (detail::is_english(word)) {
+        word.resize(detail::stem_english(word.data(), word.size()));
+    }
+}
+
+// Разбиение текста на нормализованные слова. Общий шаг для индексатора «Паука»
+// и поисковика, чтобы слова в индексе и в запросе совпадали: текст делится
+// по разделителям, слова приводятся к нижнему регистру, слова короче 3 и длиннее
+// 32 букв отбрасываются, остальные при use_stemming сводятся к основе
+inline std::vector<std::string> normalize_text(std::string_view text, bool use_stemming = true) {
+    std::vector<std::string> words;
+    std::string word;
+    auto flush = [&] {
+        if (word.empty()) return;
+        to_lower_utf8(word);
+        const std::size_t letters = letter_count(word);
+        if (letters >= 3 && letters <= 32) {
+            if (use_stemming) stem(word);
+            words.push_back(word);
+        }
+        word.clear();
+    };
+
+    for (std::size_t i = 0; i < text.size();) {
+        if (const std::size_t separator = detail::separator_length(text, i)) {
+            flush();
+            i += separator;
+        } else {
+            word += text[i++];
+        }
+    }
+    flush();
+    return words;
+}
+
+} // namespace stemmer
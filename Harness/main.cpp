@@ -0,0 +1,635 @@
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <thread>
+#include <mutex>
+#include <atomic>
+#include <memory>
+#include <chrono>
+#include <random>
+#include <algorithm>
+#include <cctype>
+#include <boost/beast/core.hpp>
+#include <boost/beast/http.hpp>
+#include <boost/beast.hpp>
+#include <boost/asio.hpp>
+#include <boost/asio/ssl.hpp>
+#include <boost/filesystem.hpp>
+#include <boost/property_tree/ptree.hpp>
+#include <boost/property_tree/ini_parser.hpp>
+#include <pqxx/pqxx>
+#include <csignal>
+#include <fcntl.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+// Нагрузочный стенд для всей системы. Работает полностью локально:
+// 1) поднимает сайт-заглушку со сгенерированным (или записанным в файл) графом ссылок;
+// 2) запускает SpiderExecutable против этого сайта и отдельной базы PostgreSQL
+//    и измеряет страницы/с, байты/с и строки БД/с;
+// 3) запускает SearchEngineExecutable и проигрывает журнал запросов
+//    замкнутым циклом из нескольких соединений, измеряя пропускную способность и задержки.
+
+//Создаем пространства имен для упрощения работы
+namespace beast = boost::beast;
+namespace http = beast::http;
+namespace net = boost::asio;
+namespace fs = boost::filesystem;
+using tcp = boost::asio::ip::tcp;
+using Clock = std::chrono::steady_clock;
+
+// Настройки из конфигурационного файла
+std::string db_host, db_port, db_name, db_user, db_password;
+
+int site_port;                 // Порт сайта-заглушки
+int site_pages;                // Количество страниц в сгенерированном графе
+int site_links_per_page;       // Количество исходящих ссылок на странице
+int site_page_size;            // Средний размер страницы в байтах
+int site_latency_ms;           // Задержка перед ответом сайта
+int site_seed;                 // Начальное значение генератора случайных чисел
+std::string graph_file;        // Записанный граф ссылок (необязательно)
+std::string tls_cert, tls_key; // Сертификат и ключ для HTTPS (необязательно)
+
+int crawl_depth;               // Глубина обхода для «Паука»
+int crawl_timeout;             // Максимальное время обхода в секундах
+int crawl_idle;                // Сколько секунд без новых запросов считать концом обхода
+std::string harness_db_name;   // Отдельная база данных для стенда
+
+int search_port;               // Порт поисковика во время замера
+std::string query_log;         // Журнал запросов, по одному запросу в строке (необязательно)
+int query_connections;         // Количество одновременных соединений клиента
+int query_duration;            // Длительность проигрывания запросов в секундах
+
+std::string spider_path, search_engine_path;
+
+// Статистика сайта-заглушки
+std::atomic<long long> pages_served{0};
+std::atomic<long long> bytes_served{0};
+std::atomic<long long> last_request_ms{0};
+std::atomic<long long> distinct_pages_served{0};
+std::vector<std::atomic<bool>> page_fetched; // Запрашивалась ли страница хотя бы раз
+Clock::time_point harness_start = Clock::now();
+
+long long elapsed_ms() {
+    return std::chrono::duration_cast<std::chrono::milliseconds>(Clock::now() - harness_start).count();
+}
+
+// Словарь сайта: основы с набором окончаний, чтобы на страницах
+// встречались разные словоформы одного слова, как на настоящих сайтах
+std::vector<std::string> build_vocabulary() {
+    const std::vector<std::string> ru_stems = {
+        "поиск", "документ", "запрос", "индекс", "сервер", "паук", "ответ", "текст",
+        "систем", "страниц", "ссылк", "баз", "программ", "очеред", "глубин", "частот"
+    };
+    const std::vector<std::string> ru_endings = {"а", "ы", "е", "у", "ой", "ами", "ах", "ом"};
+    const std::vector<std::string> en_stems = {
+        "search", "index", "crawl", "rank", "query", "link", "page", "word",
+        "connect", "request", "respond", "count", "store", "parse", "load", "build"
+    };
+    const std::vector<std::string> en_endings = {"", "s", "ed", "ing", "er", "ers"};
+
+    std::vector<std::string> words;
+    for (const auto& stem : ru_stems) {
+        for (const auto& ending : ru_endings) words.push_back(stem + ending);
+    }
+    for (const auto& stem : en_stems) {
+        for (const auto& ending : en_endings) words.push_back(stem + ending);
+    }
+    return words;
+}
+
+// Граф ссылок: для каждой страницы список страниц, на которые она ссылается.
+// Формат файла: «N: a b c» — страница N ссылается на страницы a, b и c
+std::vector<std::vector<int>> build_graph(std::mt19937& rng) {
+    std::vector<std::vector<int>> graph;
+    if (!graph_file.empty()) {
+        std::ifstream in(graph_file);
+        if (!in) throw std::runtime_error("Не удалось открыть файл графа: " + graph_file);
+        std::string line;
+        while (std::getline(in, line)) {
+            std::replace(line.begin(), line.end(), ':', ' ');
+            std::istringstream iss(line);
+            int page = 0;
+            if (!(iss >> page) || page < 0) continue;
+            if (page >= static_cast<int>(graph.size())) graph.resize(page + 1);
+            int link = 0;
+            while (iss >> link) {
+                if (link < 0) continue;
+                if (link >= static_cast<int>(graph.size())) graph.resize(link + 1);
+                graph[page].push_back(link);
+            }
+        }
+        return graph;
+    }
+
+    graph.resize(site_pages);
+    std::uniform_int_distribution<int> pick(0, site_pages - 1);
+    for (int page = 0; page < site_pages; ++page) {
+        for (int i = 0; i < site_links_per_page; ++i) {
+            graph[page].push_back(pick(rng));
+        }
+    }
+    return graph;
+}
+
+// Генерация HTML всех страниц заранее, чтобы сайт не тратил время на генерацию при ответе
+std::vector<std::string> build_pages(const std::vector<std::vector<int>>& graph,
+                                     const std::vector<std::string>& vocabulary, std::mt19937& rng) {
+    // Частоты слов по закону Ципфа, как в естественных текстах
+    std::vector<double> weights;
+    for (size_t i = 0; i < vocabulary.size(); ++i) weights.push_back(1.0 / (i + 1));
+    std::shuffle(weights.begin(), weights.end(), rng);
+    std::discrete_distribution<size_t> pick_word(weights.begin(), weights.end());
+    std::uniform_int_distribution<int> pick_size(site_page_size / 2, site_page_size * 3 / 2);
+
+    std::vector<std::string> pages;
+    pages.reserve(graph.size());
+    for (size_t page = 0; page < graph.size(); ++page) {
+        std::string html = "<html><head><title>Page " + std::to_string(page) + "</title></head><body>\n<p>";
+        for (int link : graph[page]) {
+            html += "<a href=\"/page/" + std::to_string(link) + "\">" + vocabulary[pick_word(rng)] + "</a>\n";
+        }
+        const size_t target_size = static_cast<size_t>(pick_size(rng));
+        while (html.size() < target_size) {
+            html += vocabulary[pick_word(rng)];
+            html += ' ';
+        }
+        html += "</p>\n</body></html>";
+        pages.push_back(std::move(html));
+    }
+    return pages;
+}
+
+// Обработка соединений сайта-заглушки. Работает как с TCP, так и с SSL потоком
+template<class Stream>
+void handle_site_session(Stream& stream, const std::vector<std::string>& pages) {
+    beast::flat_buffer buffer;
+    beast::error_code ec;
+    for (;;) {
+        http::request<http::string_body> req;
+        http::read(stream, buffer, req, ec);
+        if (ec) break; // Клиент закрыл соединение
+
+        last_request_ms = elapsed_ms();
+        if (site_latency_ms > 0) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(site_latency_ms));
+        }
+
+        http::response<http::string_body> res{http::status::ok, req.version()};
+        res.set(http::field::content_type, "text/html; charset=utf-8");
+        res.keep_alive(req.keep_alive());
+
+        const std::string target(req.target());
+        const std::string prefix = "/page/";
+        int page = -1;
+        if (target.find(prefix) == 0) {
+            try {
+                page = std::stoi(target.substr(prefix.size()));
+            } catch (...) {}
+        }
+        if (page >= 0 && page < static_cast<int>(pages.size())) {
+            res.body() = pages[page];
+            pages_served++;
+            if (!page_fetched[page].exchange(true)) distinct_pages_served++;
+            bytes_served += static_cast<long long>(res.body().size());
+        } else {
+            res.result(http::status::not_found);
+            res.body() = "<html><body>Not found</body></html>";
+        }
+        res.prepare_payload();
+
+        http::write(stream, res, ec);
+        if (ec || !res.keep_alive()) break;
+    }
+}
+
+// Сайт-заглушка: один поток на соединение, чтобы задержка ответа не блокировала других клиентов
+void accept_site_connections(tcp::acceptor& acceptor, const std::vector<std::string>& pages, net::ssl::context* tls) {
+    acceptor.async_accept([&acceptor, &pages, tls](beast::error_code ec, tcp::socket socket) {
+        if (ec) return; // Сайт остановлен
+        std::thread([socket = std::move(socket), &pages, tls]() mutable {
+            try {
+                if (tls) {
+                    net::ssl::stream<tcp::socket> stream(std::move(socket), *tls);
+                    stream.handshake(net::ssl::stream_base::server);
+                    handle_site_session(stream, pages);
+                    beast::error_code ec;
+                    stream.shutdown(ec);
+                } else {
+                    handle_site_session(socket, pages);
+                    beast::error_code ec;
+                    socket.shutdown(tcp::socket::shutdown_both, ec);
+                }
+            } catch (const std::exception& e) {
+                std::cerr << "Ошибка сайта-заглушки: " << e.what() << "\n";
+            }
+        }).detach();
+        accept_site_connections(acceptor, pages, tls);
+    });
+}
+
+std::string connection_string(const std::string& name) {
+    return "host=" + db_host + " port=" + db_port + " dbname=" + name + " user=" + db_user + " password=" + db_password;
+}
+
+// Подготовка отдельной базы данных для стенда: создаём её при необходимости
+// и удаляем таблицы, оставшиеся от прошлого запуска
+void prepare_database() {
+    {
+        pqxx::connection C(connection_string(db_name));
+        pqxx::nontransaction N(C);
+        auto r = N.exec("SELECT 1 FROM pg_database WHERE datname = " + N.quote(harness_db_name));
+        if (r.empty()) {
+            N.exec0("CREATE DATABASE " + N.quote_name(harness_db_name));
+        }
+    }
+    pqxx::connection C(connection_string(harness_db_name));
+    pqxx::work W(C);
+    W.exec0("DROP TABLE IF EXISTS document_word_frequency, words, documents;");
+    W.commit();
+}
+
+// Количество строк во всех таблицах индекса. Пока «Паук» не создал таблицы, возвращаем 0
+long long count_rows(pqxx::connection& C, const std::string& table) {
+    try {
+        pqxx::work W(C);
+        long long count = W.query_value<long long>("SELECT count(*) FROM " + table);
+        W.commit();
+        return count;
+    } catch (const pqxx::sql_error&) {
+        return 0;
+    }
+}
+
+// Конфигурация для запускаемых программ: те же настройки, но отдельная база и локальный сайт
+void write_child_config(const fs::path& work_dir, const std::string& start_url) {
+    boost::property_tree::ptree pt;
+    boost::property_tree::ini_parser::read_ini("config.ini", pt);
+    pt.put("database.dbname", harness_db_name);
+    pt.put("server.server_port", search_port);
+    pt.put("start.start_url", start_url);
+    pt.put("start.depth", crawl_depth);
+    boost::property_tree::ini_parser::write_ini((work_dir / "config.ini").string(), pt);
+}
+
+// Запуск программы в рабочем каталоге стенда, вывод перенаправляется в log_name
+pid_t start_process(const fs::path& executable, const fs::path& work_dir, const std::string& log_name) {
+    const std::string exe = executable.string();
+    const std::string dir = work_dir.string();
+    const std::string log = (work_dir / log_name).string();
+
+    pid_t pid = fork();
+    if (pid == 0) {
+        // Закрываем унаследованные дескрипторы стенда (слушающий сокет сайта, соединения с базой),
+        // иначе после завершения стенда дочерняя программа продолжит держать порт сайта
+        long max_fd = sysconf(_SC_OPEN_MAX);
+        if (max_fd < 0 || max_fd > 65536) max_fd = 65536;
+        for (int fd = STDERR_FILENO + 1; fd < max_fd; ++fd) close(fd);
+
+        if (chdir(dir.c_str()) != 0) _exit(127);
+        int fd = open(log.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+        if (fd >= 0) {
+            dup2(fd, STDOUT_FILENO);
+            dup2(fd, STDERR_FILENO);
+            close(fd);
+        }
+        execl(exe.c_str(), exe.c_str(), static_cast<char*>(nullptr));
+        _exit(127);
+    }
+    if (pid < 0) throw std::runtime_error("Не удалось запустить " + exe);
+    return pid;
+}
+
+void stop_process(pid_t pid) {
+    kill(pid, SIGTERM);
+    waitpid(pid, nullptr, 0);
+}
+
+// Запущенная программа. Останавливается при выходе из области видимости,
+// в том числе при исключении, чтобы после ошибки стенда не оставалось работающих процессов
+struct ChildProcess {
+    pid_t pid;
+
+    explicit ChildProcess(pid_t pid) : pid(pid) {}
+    ChildProcess(const ChildProcess&) = delete;
+    ChildProcess& operator=(const ChildProcess&) = delete;
+    ~ChildProcess() { stop(); }
+
+    void stop() {
+        if (pid > 0) stop_process(pid);
+        pid = -1;
+    }
+};
+
+// Замер обхода: запускаем «Паука» и ждём, пока сайт перестанет получать запросы,
+// а количество строк в базе — меняться
+void run_crawl_benchmark(const fs::path& work_dir) {
+    pqxx::connection C(connection_string(harness_db_name));
+
+    const long long start_ms = elapsed_ms();
+    last_request_ms = start_ms;
+    ChildProcess spider(start_process(fs::absolute(spider_path), work_dir, "spider.log"));
+
+    // Строки таблиц индекса на момент последнего изменения и время этого изменения
+    long long documents = 0, words = 0, frequencies = 0;
+    long long last_write_ms = start_ms;
+
+    for (;;) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(200));
+        const long long now = elapsed_ms();
+
+        const long long current_documents = count_rows(C, "documents");
+        const long long current_words = count_rows(C, "words");
+        const long long current_frequencies = count_rows(C, "document_word_frequency");
+        if (current_documents != documents || current_words != words || current_frequencies != frequencies) {
+            documents = current_documents;
+            words = current_words;
+            frequencies = current_frequencies;
+            last_write_ms = now;
+        }
+
+        int status = 0;
+        if (waitpid(spider.pid, &status, WNOHANG) == spider.pid) {
+            std::cerr << "SpiderExecutable завершился досрочно, см. " << (work_dir / "spider.log").string() << "\n";
+            spider.pid = -1;
+            break;
+        }
+        const long long last_activity_ms = std::max(last_request_ms.load(), last_write_ms);
+        if (now - last_activity_ms > crawl_idle * 1000LL) break;
+        if (now - start_ms > crawl_timeout * 1000LL) {
+            std::cerr << "Обход прерван по таймауту\n";
+            break;
+        }
+    }
+    spider.stop();
+
+    // Окно замера заканчивается последним запросом к сайту или последней записью в базу,
+    // смотря что было позже. Количество строк взято в тот же момент
+    const long long window_end_ms = std::max(last_request_ms.load(), last_write_ms);
+    const double seconds = std::max(1LL, window_end_ms - start_ms) / 1000.0;
+    const long long pages = pages_served.load();
+    const long long distinct_pages = distinct_pages_served.load();
+
+    // Строки в базе — это сохранённые строки: повторные вставки «Паука»
+    // отбрасываются ON CONFLICT DO NOTHING и здесь не учитываются
+    std::cout << "crawl: pages=" << pages << " distinct pages=" << distinct_pages
+              << " bytes=" << bytes_served.load() << " elapsed=" << seconds << "s\n"
+              << "crawl: pages/sec=" << pages / seconds
+              << " duplicate fetch ratio=" << (pages > 0 ? static_cast<double>(pages - distinct_pages) / pages : 0.0)
+              << " bytes/sec=" << bytes_served.load() / seconds
+              << " db rows stored/sec=" << (documents + words + frequencies) / seconds << "\n"
+              << "crawl: documents=" << documents << " words=" << words
+              << " document_word_frequency=" << frequencies << "\n";
+}
+
+// Кодирование значения поля формы для тела POST-запроса
+std::string url_encode(const std::string& value) {
+    static const char hex[] = "0123456789ABCDEF";
+    std::string encoded;
+    for (unsigned char c : value) {
+        if (std::isalnum(c) || c == '-' || c == '_' || c == '.' || c == '~') {
+            encoded += static_cast<char>(c);
+        } else if (c == ' ') {
+            encoded += '+';
+        } else {
+            encoded += '%';
+            encoded += hex[c >> 4];
+            encoded += hex[c & 0x0F];
+        }
+    }
+    return encoded;
+}
+
+// Журнал запросов: из файла либо сгенерированный из словаря сайта (от одного до трёх слов)
+std::vector<std::string> load_queries(const std::vector<std::string>& vocabulary, std::mt19937& rng) {
+    std::vector<std::string> queries;
+    if (!query_log.empty()) {
+        std::ifstream in(query_log);
+        if (!in) throw std::runtime_error("Не удалось открыть журнал запросов: " + query_log);
+        std::string line;
+        while (std::getline(in, line)) {
+            if (!line.empty()) queries.push_back(line);
+        }
+        return queries;
+    }
+
+    std::uniform_int_distribution<size_t> pick_word(0, vocabulary.size() - 1);
+    std::uniform_int_distribution<int> pick_count(1, 3);
+    for (int i = 0; i < 1000; ++i) {
+        std::string query;
+        for (int j = pick_count(rng); j > 0; --j) {
+            if (!query.empty()) query += ' ';
+            query += vocabulary[pick_word(rng)];
+        }
+        queries.push_back(query);
+    }
+    return queries;
+}
+
+// Ожидание, пока поисковик начнёт принимать соединения
+bool wait_for_port(int port, int timeout_seconds) {
+    const auto deadline = Clock::now() + std::chrono::seconds(timeout_seconds);
+    net::io_context ioc;
+    while (Clock::now() < deadline) {
+        tcp::socket socket{ioc};
+        beast::error_code ec;
+        socket.connect(tcp::endpoint(net::ip::make_address("127.0.0.1"), port), ec);
+        if (!ec) return true;
+        std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    }
+    return false;
+}
+
+// Замер поиска: каждое соединение отправляет следующий запрос сразу после получения ответа.
+// Возвращает false, если ни один запрос не нашёл ни одного документа
+bool run_search_benchmark(const fs::path& work_dir, const std::vector<std::string>& queries) {
+    ChildProcess engine(start_process(fs::absolute(search_engine_path), work_dir, "search_engine.log"));
+    if (!wait_for_port(search_port, 10)) {
+        throw std::runtime_error("SearchEngineExecutable не начал принимать соединения");
+    }
+
+    std::atomic<size_t> next_query{0};
+    std::atomic<long long> errors{0};
+    std::atomic<long long> hits{0};    // Ответы хотя бы с одной ссылкой на документ
+    std::atomic<long long> empty{0};   // Ответы со страницей «Результаты не найдены»
+    std::mutex latencies_mutex;
+    std::vector<double> latencies; // Задержки в миллисекундах
+    const auto deadline = Clock::now() + std::chrono::seconds(query_duration);
+    const auto start = Clock::now();
+
+    std::vector<std::thread> clients;
+    for (int i = 0; i < query_connections; ++i) {
+        clients.emplace_back([&] {
+            net::io_context ioc;
+            const tcp::endpoint endpoint(net::ip::make_address("127.0.0.1"), search_port);
+            std::vector<double> local;
+            while (Clock::now() < deadline) {
+                const std::string& query = queries[next_query++ % queries.size()];
+                const auto sent = Clock::now();
+                try {
+                    // Поисковик закрывает соединение после каждого ответа, поэтому подключаемся заново
+                    beast::tcp_stream stream(ioc);
+                    stream.connect(endpoint);
+
+                    http::request<http::string_body> req{http::verb::post, "/", 11};
+                    req.set(http::field::host, "127.0.0.1");
+                    req.set(http::field::user_agent, "Boost.Beast");
+                    req.set(http::field::content_type, "application/x-www-form-urlencoded");
+                    req.body() = "query=" + url_encode(query);
+                    req.prepare_payload();
+                    http::write(stream, req);
+
+                    beast::flat_buffer buffer;
+                    http::response<http::string_body> res;
+                    http::read(stream, buffer, res);
+                    if (res.result() != http::status::ok) {
+                        errors++;
+                    } else if (res.body().find("<li><a href=") != std::string::npos) {
+                        hits++;
+                    } else {
+                        empty++;
+                    }
+
+                    beast::error_code ec;
+                    stream.socket().shutdown(tcp::socket::shutdown_both, ec);
+                } catch (const std::exception&) {
+                    errors++;
+                    continue;
+                }
+                local.push_back(std::chrono::duration<double, std::milli>(Clock::now() - sent).count());
+            }
+            std::lock_guard lock(latencies_mutex);
+            latencies.insert(latencies.end(), local.begin(), local.end());
+        });
+    }
+    for (auto& client : clients) client.join();
+    const double seconds = std::chrono::duration<double>(Clock::now() - start).count();
+    engine.stop();
+
+    std::sort(latencies.begin(), latencies.end());
+    auto percentile = [&](double p) {
+        if (latencies.empty()) return 0.0;
+        size_t index = static_cast<size_t>(p * (latencies.size() - 1));
+        return latencies[index];
+    };
+
+    std::cout << "search: requests=" << latencies.size() << " errors=" << errors.load()
+              << " connections=" << query_connections << " elapsed=" << seconds << "s\n"
+              << "search: throughput=" << latencies.size() / seconds << " req/sec"
+              << " p50=" << percentile(0.50) << "ms"
+              << " p95=" << percentile(0.95) << "ms"
+              << " p99=" << percentile(0.99) << "ms\n"
+              << "search: hits=" << hits.load() << " empty=" << empty.load() << "\n";
+
+    // Поиск, который ничего не находит, — такая же регрессия, как и ошибки
+    if (hits.load() == 0) {
+        std::cerr << "Ни один запрос не вернул результатов, см. "
+                  << (work_dir / "search_engine.log").string() << "\n";
+        return false;
+    }
+    return true;
+}
+
+
+// Основная функция
+int main() {
+
+    // Загружаем настройки из config.ini
+    boost::property_tree::ptree pt;
+    boost::property_tree::ini_parser::read_ini("config.ini", pt);
+
+    db_host = pt.get<std::string>("database.host");
+    db_port = pt.get<std::string>("database.port");
+    db_name = pt.get<std::string>("database.dbname");
+    db_user = pt.get<std::string>("database.user");
+    db_password = pt.get<std::string>("database.password");
+
+    site_port = pt.get<int>("harness.site_port", 8090);
+    site_pages = pt.get<int>("harness.site_pages", 200);
+    site_links_per_page = pt.get<int>("harness.site_links_per_page", 8);
+    site_page_size = pt.get<int>("harness.site_page_size", 8192);
+    site_latency_ms = pt.get<int>("harness.site_latency_ms", 20);
+    site_seed = pt.get<int>("harness.site_seed", 42);
+    graph_file = pt.get<std::string>("harness.graph_file", "");
+    tls_cert = pt.get<std::string>("harness.tls_cert", "");
+    tls_key = pt.get<std::string>("harness.tls_key", "");
+
+    crawl_depth = pt.get<int>("harness.crawl_depth", 3);
+    crawl_timeout = pt.get<int>("harness.crawl_timeout", 120);
+    crawl_idle = pt.get<int>("harness.crawl_idle", 5);
+    harness_db_name = pt.get<std::string>("harness.dbname", db_name + "_harness");
+    if (harness_db_name == db_name) {
+        // Стенд удаляет таблицы в своей базе, поэтому настоящий индекс трогать нельзя
+        std::cerr << "Ошибка: harness.dbname совпадает с database.dbname (" << db_name << ")\n";
+        return 1;
+    }
+
+    search_port = pt.get<int>("harness.search_port", 8091);
+    query_log = pt.get<std::string>("harness.query_log", "");
+    query_connections = pt.get<int>("harness.query_connections", 8);
+    query_duration = pt.get<int>("harness.query_duration", 20);
+
+    spider_path = pt.get<std::string>("harness.spider_path", "./SpiderExecutable");
+    search_engine_path = pt.get<std::string>("harness.search_engine_path", "./SearchEngineExecutable");
+
+    try {
+        std::mt19937 rng(static_cast<std::mt19937::result_type>(site_seed));
+        const auto vocabulary = build_vocabulary();
+        const auto graph = build_graph(rng);
+        if (graph.empty()) throw std::runtime_error("Граф ссылок пуст");
+        const auto pages = build_pages(graph, vocabulary, rng);
+        page_fetched = std::vector<std::atomic<bool>>(pages.size());
+        const auto queries = load_queries(vocabulary, rng);
+        if (queries.empty()) throw std::runtime_error("Журнал запросов пуст");
+
+        // Сайт-заглушка слушает только локальный интерфейс
+        net::io_context ioc;
+        tcp::acceptor acceptor{ioc, tcp::endpoint(net::ip::make_address("127.0.0.1"), static_cast<unsigned short>(site_port))};
+        fcntl(acceptor.native_handle(), F_SETFD, FD_CLOEXEC); // Не передаём сокет сайта запускаемым программам
+
+        std::unique_ptr<net::ssl::context> tls;
+        if (!tls_cert.empty() && !tls_key.empty()) {
+            tls = std::make_unique<net::ssl::context>(net::ssl::context::tls_server);
+            tls->use_certificate_chain_file(tls_cert);
+            tls->use_private_key_file(tls_key, net::ssl::context::pem);
+        }
+        accept_site_connections(acceptor, pages, tls.get());
+        std::thread site_thread([&ioc] { ioc.run(); });
+        // Останавливаем сайт на любом пути выхода: поток, оставшийся joinable
+        // при раскрутке стека после исключения, вызвал бы std::terminate
+        struct SiteStopper {
+            net::io_context& ioc;
+            std::thread& thread;
+            ~SiteStopper() {
+                ioc.stop();
+                if (thread.joinable()) thread.join();
+            }
+        } site_stopper{ioc, site_thread};
+
+        const std::string start_url = std::string(tls ? "https" : "http") +
+                                      "://127.0.0.1:" + std::to_string(site_port) + "/page/0";
+        std::cout << "site: " << start_url << " pages=" << pages.size()
+                  << " latency=" << site_latency_ms << "ms page_size~" << site_page_size << "\n";
+
+        // Рабочий каталог для запускаемых программ с собственным config.ini и логами
+        const fs::path work_dir = fs::temp_directory_path() / fs::unique_path("search-harness-%%%%-%%%%");
+        fs::create_directories(work_dir);
+        write_child_config(work_dir, start_url);
+        std::cout << "work dir: " << work_dir.string() << "\n";
+
+        prepare_database();
+        run_crawl_benchmark(work_dir);
+        if (!run_search_benchmark(work_dir, queries)) return 1;
+    } catch (const pqxx::sql_error& e) {
+        std::cerr << "Ошибка базы данных: " << e.what() << "\n";
+        return 1;
+    } catch (const std::exception& e) {
+        std::cerr << "Ошибка: " << e.what() << "\n";
+        return 1;
+    }
+
+    return 0;
+
+}
@@ -7,6 +7,8 @@
 #include <boost/property_tree/ptree.hpp>
 #include <boost/property_tree/ini_parser.hpp>
 #include <regex>
+#include <cctype>
+#include "stemmer.h"
 
 namespace beast = boost::beast;       
 namespace http = beast::http;           
@@ -15,6 +17,7 @@ using tcp = boost::asio::ip::tcp;
 // Настройки из конфигурационного файла.
 std::string db_host, db_port, db_name, db_user, db_password;
 int server_port;
+bool use_stemming = true;
 
 
 // Функция выполнения SQL-запроса для поиска документов.
@@ -52,9 +55,12 @@ std::vector<std::pair<int, std::string>> search_documents(const std::vector<std:
         // Выполнение подготовленного запроса с параметрами
         // Параметры передаем как аргументы функции exec_prepared
         // Важно: параметры должны быть в том же порядке, что и плейсхолдеры
-        std::vector<std::string> params = search_words; // просто копируем
+        pqxx::params params;
+        for (const auto& word : search_words) {
+            params.append(word);
+        }
 
-        auto r = W.exec("search_words");
+        auto r = W.exec_prepared("search_words", params);
 
         for (const auto& row : r) {
             int doc_id = row[0].as<int>();
@@ -72,6 +78,35 @@ std::vector<std::pair<int, std::string>> search_documents(const std::vector<std:
     return results;
 }
 
+// Декодирование значения поля формы (application/x-www-form-urlencoded):
+// "+" превращается в пробел, а последовательности %XX — в байты
+std::string url_decode(const std::string& value) {
+    std::string decoded;
+    decoded.reserve(value.size());
+    for (size_t i = 0; i < value.size(); ++i) {
+        if (value[i] == '+') {
+            decoded += ' ';
+        } else if (value[i] == '%' && i + 2 < value.size() &&
+                   std::isxdigit(static_cast<unsigned char>(value[i + 1])) &&
+                   std::isxdigit(static_cast<unsigned char>(value[i + 2]))) {
+            decoded += static_cast<char>(std::stoi(value.substr(i + 1, 2), nullptr, 16));
+            i += 2;
+        } else {
+            decoded += value[i];
+        }
+    }
+    return decoded;
+}
+
+// Нормализация запроса тем же шагом, что и у индексатора «Паука»
+std::vector<std::string> normalize_query(const std::string& query) {
+    std::vector<std::string> words = stemmer::normalize_text(query, use_stemming);
+    if (words.size() > 4) {
+        words.resize(4); // Собираем до 4 слов пользователя в контейнер
+    }
+    return words;
+}
+
 // Простая функция для генерации HTML страницы поиска
 std::string generate_search_form() {
     return "<html>\n"
@@ -122,14 +157,9 @@ http::response<http::string_body> handle_request(const http::request<Body>& req)
             std::vector<std::string> search_words; //контейнера для слов поиска пользователя
 
             if (std::regex_search(body_str, match, re)) {
-                std::string query_raw = match[1];
-                // Нужно ли добавить url-декодинг?
-                // Разделияем на слова по пробелам:
-                std::istringstream iss(query_raw); 
-                std::string word;
-                while (iss >> word && search_words.size() < 4) { 
-                    search_words.push_back(word); //Собираем до 4 слов пользователя в контейнер
-                }
+                std::string query_raw = url_decode(match[1]);
+                // Разделяем на слова и приводим их к тому же виду, что и в индексе
+                search_words = normalize_query(query_raw);
             }
 
             if (search_words.empty()) {
@@ -184,6 +214,7 @@ int main() {
    db_user = pt.get<std::string>("database.user");
    db_password = pt.get<std::string>("database.password");
    server_port = pt.get<int>("server.server_port");
+   use_stemming = pt.get<bool>("index.stemming", true);
 
    try{
     boost::asio::io_context ioc{1};
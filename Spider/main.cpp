@@ -18,6 +18,7 @@
 #include <regex>
 #include <locale>
 #include <algorithm>
+#include "stemmer.h"
 
 //Создаем пространства имен для упрощения работы
 namespace beast = boost::beast;
@@ -38,6 +39,7 @@ boost::asio::ssl::context ctx(boost::asio::ssl::context::sslv23_client);
 std::string db_host, db_port, db_name, db_user, db_password;
 std::string start_url;
 int depth;
+bool use_stemming = true;
 
 // Функция для создания таблиц в базе данных
 void create_tables() {
@@ -129,6 +131,15 @@ std::string load_page(const std::string& url, int redirect_count = 0) {
             host = url;
             target = "/";
         }
+
+        // Порт может быть указан явно (host:port), иначе берём стандартный для схемы
+        std::string host_header = host;
+        std::string port = scheme == "https" ? "443" : "80";
+        auto port_pos = host.find(':');
+        if (port_pos != std::string::npos) {
+            port = host.substr(port_pos + 1);
+            host = host.substr(0, port_pos);
+        }
         
         // Перед обработкой редиректа или возвратом содержимого
         if (should_ignore_link(target)) {
@@ -144,7 +155,7 @@ std::string load_page(const std::string& url, int redirect_count = 0) {
             boost::asio::ip::tcp::resolver resolver(ioc);
 
             std::cout << "Trying to resolve: " << host << std::endl;
-            auto results = resolver.resolve(host, "443");
+            auto results = resolver.resolve(host, port);
             std::cout << host << " successfully resolved" << std::endl;
 
             // Подключение
@@ -161,7 +172,7 @@ std::string load_page(const std::string& url, int redirect_count = 0) {
 
             // Формируем HTTP-запрос
             http::request<http::string_body> req{http::verb::get,target,11};
-            req.set(http::field::host,host);
+            req.set(http::field::host,host_header);
             req.set(http::field::user_agent,"Boost.Beast");
 
             try {
@@ -227,14 +238,14 @@ std::string load_page(const std::string& url, int redirect_count = 0) {
             boost::asio::ip::tcp::resolver resolver(ioc);
 
             std::cout << "Trying to resolve: " << host << std::endl;
-            auto results = resolver.resolve(host,"80");
+            auto results = resolver.resolve(host,port);
             std::cout << host << "successfully resolved" << std::endl;
 
             boost::beast::tcp_stream stream(ioc);
             net::connect(stream.socket(),results.begin(),results.end());
              
             http::request<http::string_body>req{http::verb::get,target,11};
-            req.set(http::field::host,host);
+            req.set(http::field::host,host_header);
             req.set(http::field::user_agent,"Boost.Beast");
             try {
                 
@@ -339,21 +350,10 @@ void index_page(const std::string& url, const std::string& html_content) {
     // Очищаем HTML-теги
     std::string text = std::regex_replace(html_content, std::regex("<[^>]+>"), " ");
     
-    // Удаляем знаки препинания и лишние пробелы
-    text = std::regex_replace(text, std::regex("([^\\w\\s])"), " ");
-    text = std::regex_replace(text, std::regex("(\\s+)"), " ");
-    // Приводим текст к нижнему регистру
-    std::transform(text.begin(), text.end(), text.begin(), ::tolower);
-
-    // Разделяем текст на слова и считаем частоту
-    std::istringstream iss(text);
+    // Разделяем текст на нормализованные слова и считаем частоту
     std::map<std::string, int> word_count;
-    std::string word;
-
-    while (iss >> word) {
-        if (word.length() >= 3 && word.length() <= 32) { // Фильтруем слова по длине
-            word_count[word]++;
-        }
+    for (const auto& word : stemmer::normalize_text(text, use_stemming)) {
+        word_count[word]++;
     }
 
     // Сохраняем данные в базу данных
@@ -445,6 +445,7 @@ int main() {
 
     start_url = pt.get<std::string>("start.start_url");
     depth = pt.get<int>("start.depth");
+    use_stemming = pt.get<bool>("index.stemming", true);
 
     create_tables(); // Вызов функции создания таблицы
 